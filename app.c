@@ -10,6 +10,8 @@ void print_menu() {
     printf("3. Algorithm Demo\n");
     printf("4. Container Utilities Demo\n");
     printf("5. Run C Functions\n");
+    printf("6. mmap_vector Demo\n");
+    printf("7. unrolled_list Demo\n");
     printf("0. Exit\n");
     printf("Enter your choice: ");
 }
@@ -45,6 +47,14 @@ int main() {
                 printf("%d - %d = %d\n", a, b, subtract(a, b));
                 break;
                 
+            case 6:
+                run_mmap_vector_demo();
+                break;
+                
+            case 7:
+                run_unrolled_list_demo();
+                break;
+                
             case 0:
                 printf("Exiting...\n");
                 break;
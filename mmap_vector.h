@@ -0,0 +1,242 @@
+#ifndef MMAP_VECTOR_H
+#define MMAP_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Vector for trivially copyable types whose large buffers come straight from mmap.
+//
+// - Small buffers (below mmap_threshold) live on the malloc heap.
+// - Large buffers are anonymous mappings; on Linux they grow and shrink with
+//   mremap, so the kernel moves page tables instead of copying elements.
+// - With page_mode::huge, mappings are sized in 2 MiB steps and advised
+//   with MADV_HUGEPAGE to cut TLB misses on long sequential scans.
+// - shrink_to_fit() hands the unused tail pages back to the kernel.
+// Page size policy for mmap_vector's mapped buffers. A dedicated type rather
+// than a bool, so mmap_vector<T> v(n) does not silently mean "huge pages".
+enum class page_mode { normal, huge };
+
+template <typename T>
+class mmap_vector {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "mmap_vector relocates elements with memcpy/mremap");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr size_type mmap_threshold = 128 * 1024;    // bytes, same as glibc's default
+    static constexpr size_type huge_page_size = 2 * 1024 * 1024;
+
+    explicit mmap_vector(page_mode mode = page_mode::normal) : huge_pages_(mode == page_mode::huge) {}
+
+    mmap_vector(const mmap_vector& other) : huge_pages_(other.huge_pages_) {
+        reserve(other.size_);
+        if (other.size_) {
+            std::memcpy(data_, other.data_, other.size_ * sizeof(T));
+        }
+        size_ = other.size_;
+    }
+
+    mmap_vector(mmap_vector&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)),
+          mapped_bytes_(std::exchange(other.mapped_bytes_, 0)),
+          huge_pages_(other.huge_pages_) {}
+
+    mmap_vector& operator=(mmap_vector other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~mmap_vector() { release(); }
+
+    // Element access
+    T& operator[](size_type i) { return data_[i]; }
+    const T& operator[](size_type i) const { return data_[i]; }
+    T& at(size_type i) {
+        if (i >= size_) throw std::out_of_range("mmap_vector::at");
+        return data_[i];
+    }
+    const T& at(size_type i) const {
+        if (i >= size_) throw std::out_of_range("mmap_vector::at");
+        return data_[i];
+    }
+    T& front() { return data_[0]; }
+    T& back() { return data_[size_ - 1]; }
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+
+    // Iterators
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+    // Capacity
+    bool empty() const { return size_ == 0; }
+    size_type size() const { return size_; }
+    size_type capacity() const { return capacity_; }
+    bool is_mapped() const { return mapped_bytes_ != 0; }
+    bool huge_pages() const { return huge_pages_; }
+    static constexpr size_type max_size() { return SIZE_MAX / sizeof(T); }
+
+    void reserve(size_type n) {
+        if (n > max_size()) throw std::length_error("mmap_vector::reserve");
+        if (n > capacity_) reallocate(n);
+    }
+
+    void shrink_to_fit() {
+        if (capacity_ > size_) reallocate(size_);
+    }
+
+    // Modifiers
+    void push_back(const T& value) {
+        if (size_ == capacity_) {
+            T copy = value;  // value may alias the buffer that is about to move
+            grow(size_ + 1);
+            data_[size_++] = copy;
+            return;
+        }
+        data_[size_++] = value;
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            T value(std::forward<Args>(args)...);
+            grow(size_ + 1);
+            return data_[size_++] = value;
+        }
+        return *new (data_ + size_++) T(std::forward<Args>(args)...);
+    }
+
+    void pop_back() { --size_; }
+    void clear() { size_ = 0; }
+
+    void resize(size_type n, const T& value = T()) {
+        if (n > max_size()) throw std::length_error("mmap_vector::resize");
+        if (n > capacity_) reallocate(n);
+        if (n > size_) std::fill(data_ + size_, data_ + n, value);
+        size_ = n;
+    }
+
+    void swap(mmap_vector& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(mapped_bytes_, other.mapped_bytes_);
+        std::swap(huge_pages_, other.huge_pages_);
+    }
+
+private:
+    void grow(size_type needed) {
+        if (needed > max_size()) throw std::length_error("mmap_vector::grow");
+        size_type doubled = capacity_ > max_size() / 2 ? max_size() : capacity_ * 2;
+        reallocate(std::max(needed, doubled));
+    }
+
+    size_type granularity() const {
+        if (huge_pages_) return huge_page_size;
+        static const size_type page = static_cast<size_type>(sysconf(_SC_PAGESIZE));
+        return page;
+    }
+
+    void advise(void* p, size_type bytes) const {
+#ifdef MADV_HUGEPAGE
+        if (huge_pages_) madvise(p, bytes, MADV_HUGEPAGE);  // Best effort: THP may be disabled
+#else
+        (void)p;
+        (void)bytes;
+#endif
+    }
+
+    void reallocate(size_type new_cap) {
+        if (new_cap == 0) {
+            release();
+            return;
+        }
+
+        size_type bytes = new_cap * sizeof(T);
+        if (bytes < mmap_threshold) {
+            void* p;
+            if (mapped_bytes_) {
+                // Leaving the mapping: copy the (small) live prefix back to the heap
+                p = std::malloc(bytes);
+                if (!p) throw std::bad_alloc();
+                std::memcpy(p, data_, size_ * sizeof(T));
+                munmap(data_, mapped_bytes_);
+                mapped_bytes_ = 0;
+            } else {
+                p = std::realloc(data_, bytes);
+                if (!p) throw std::bad_alloc();
+            }
+            data_ = static_cast<T*>(p);
+            capacity_ = new_cap;
+            return;
+        }
+
+        if (bytes > SIZE_MAX - granularity()) throw std::bad_alloc();  // Rounding up would wrap
+        size_type map_bytes = (bytes + granularity() - 1) / granularity() * granularity();
+        void* p;
+        if (!mapped_bytes_) {
+            p = mmap(nullptr, map_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) throw std::bad_alloc();
+            if (size_) std::memcpy(p, data_, size_ * sizeof(T));
+            std::free(data_);
+        } else {
+#ifdef __linux__
+            // Grows or shrinks in place when possible, otherwise moves the page tables
+            p = mremap(data_, mapped_bytes_, map_bytes, MREMAP_MAYMOVE);
+            if (p == MAP_FAILED) throw std::bad_alloc();
+#else
+            if (map_bytes < mapped_bytes_) {
+                munmap(reinterpret_cast<char*>(data_) + map_bytes, mapped_bytes_ - map_bytes);
+                p = data_;
+            } else {
+                p = mmap(nullptr, map_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (p == MAP_FAILED) throw std::bad_alloc();
+                std::memcpy(p, data_, size_ * sizeof(T));
+                munmap(data_, mapped_bytes_);
+            }
+#endif
+        }
+        advise(p, map_bytes);
+        data_ = static_cast<T*>(p);
+        mapped_bytes_ = map_bytes;
+        capacity_ = map_bytes / sizeof(T);
+    }
+
+    void release() {
+        if (mapped_bytes_) {
+            munmap(data_, mapped_bytes_);
+        } else {
+            std::free(data_);
+        }
+        data_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+        mapped_bytes_ = 0;
+    }
+
+    T* data_ = nullptr;
+    size_type size_ = 0;
+    size_type capacity_ = 0;
+    size_type mapped_bytes_ = 0;  // 0 while the buffer lives on the malloc heap
+    bool huge_pages_;
+};
+
+#endif // MMAP_VECTOR_H
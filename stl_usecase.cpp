@@ -2,6 +2,7 @@
 #include <iostream>
 #include <vector>
 #include <list>
+#include <forward_list>
 #include <deque>
 #include <array>
 #include <map>
@@ -14,12 +15,22 @@
 #include <numeric>
 #include <string>
 #include <functional>
+#include <iterator>
 #include <tuple>
 #include <utility>
 #include <memory>
 #include <chrono>
 #include <random>
 #include <thread>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#include "mmap_vector.h"
+#include "unrolled_list.h"
 
 using namespace std;
 using namespace std::chrono;
@@ -566,6 +577,206 @@ void container_utils_demo() {
     cout << "Container utilities demo completed.\n";
 }
 
+// Peak RSS helpers for the mmap_vector benchmark (Linux /proc; 0 elsewhere)
+static long read_status_kb(const string& field) {
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line)) {
+        if (line.compare(0, field.size(), field) == 0) {
+            return stol(line.substr(field.size()));
+        }
+    }
+    return 0;
+}
+
+// Returns false when VmHWM could not be reset, i.e. it still holds an earlier peak
+static bool reset_peak_rss() {
+    // Writing 5 to clear_refs resets VmHWM to the current RSS (Linux 4.0+)
+    ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5" << flush;  // The write reaches the kernel on flush
+    return static_cast<bool>(clear_refs);
+}
+
+// Appends `bytes` worth of uint64_t one at a time and reports throughput and peak RSS
+template <typename Vec, typename Make>
+static void bench_append(const char* label, size_t bytes, Make make) {
+    size_t count = bytes / sizeof(uint64_t);
+    bool peak_valid = reset_peak_rss();
+    long base_kb = read_status_kb("VmRSS:");
+
+    auto start = steady_clock::now();
+    uint64_t last = 0;
+    {
+        Vec v = make();
+        for (uint64_t i = 0; i < count; ++i) {
+            v.push_back(i);
+        }
+        last = v.back();
+    }
+    auto elapsed = duration_cast<microseconds>(steady_clock::now() - start).count();
+
+    ostringstream peak;
+    if (peak_valid) {
+        peak << fixed << setprecision(1) << (read_status_kb("VmHWM:") - base_kb) / 1024.0 << " MB";
+    } else {
+        peak << "n/a";
+    }
+
+    double mb = bytes / (1024.0 * 1024.0);
+    double mb_per_s = elapsed ? mb / (elapsed / 1e6) : 0.0;
+    ostringstream row;  // Formatted locally so cout's flags stay untouched for later demos
+    row << "  " << left << setw(22) << label << right
+        << fixed << setprecision(0) << setw(9) << mb_per_s << " MB/s"
+        << "   peak RSS " << setw(11) << peak.str()
+        << "   (last=" << last << ")";
+    cout << row.str() << endl;
+}
+
+// mmap_vector: mremap-grown vector for trivially copyable types
+void mmap_vector_demo() {
+    cout << "\n=== mmap_vector Demo ===" << endl;
+
+    // 1. Small buffers start on the malloc heap, like std::vector
+    mmap_vector<int> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(i);
+    }
+    cout << "Size: " << v.size() << ", Capacity: " << v.capacity()
+         << ", Mapped: " << (v.is_mapped() ? "yes" : "no") << endl;
+
+    // 2. Crossing mmap_threshold moves the buffer into its own mapping;
+    //    further growth is an mremap, not an element copy
+    v.reserve(1 << 20);
+    cout << "After reserve(1 << 20): Capacity: " << v.capacity()
+         << ", Mapped: " << (v.is_mapped() ? "yes" : "no") << endl;
+
+    // 3. shrink_to_fit returns the unused tail pages to the kernel
+    v.shrink_to_fit();
+    cout << "After shrink_to_fit: Capacity: " << v.capacity()
+         << ", Mapped: " << (v.is_mapped() ? "yes" : "no") << endl;
+
+    // 4. Opt into transparent huge pages (madvise) for large buffers
+    mmap_vector<uint64_t> huge(page_mode::huge);
+    huge.resize(4 << 20);
+    cout << "Huge-page vector capacity: " << huge.capacity() << " elements ("
+         << huge.capacity() * sizeof(uint64_t) / (1024 * 1024) << " MB)" << endl;
+
+    // 5. Append benchmark against std::vector (set STL_BENCH_MAX_MB to go larger)
+    size_t max_mb = 256;
+    if (const char* env = getenv("STL_BENCH_MAX_MB")) {
+        max_mb = strtoull(env, nullptr, 10);
+    }
+    cout << "\nAppend benchmark (uint64_t, push_back only):" << endl;
+    for (size_t mb = 1; mb <= max_mb; mb *= 16) {
+        size_t bytes = mb * 1024 * 1024;
+        cout << mb << " MB:" << endl;
+        bench_append<vector<uint64_t>>("std::vector", bytes,
+            [] { return vector<uint64_t>(); });
+        bench_append<mmap_vector<uint64_t>>("mmap_vector", bytes,
+            [] { return mmap_vector<uint64_t>(); });
+        bench_append<mmap_vector<uint64_t>>("mmap_vector (THP)", bytes,
+            [] { return mmap_vector<uint64_t>(page_mode::huge); });
+    }
+
+    cout << "mmap_vector demo completed.\n";
+}
+
+// Sums a container a few times and returns the average time per pass in microseconds
+template <typename Container>
+static long long time_traversal(Container& c, long long& sum) {
+    const int passes = 5;
+    auto start = steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const auto& x : c) {
+            sum += x;
+        }
+    }
+    return duration_cast<microseconds>(steady_clock::now() - start).count() / passes;
+}
+
+// unrolled_list: pool-backed unrolled linked list with stable handles
+void unrolled_list_demo() {
+    cout << "\n=== unrolled_list Demo ===" << endl;
+    cout << "Elements per node: " << unrolled_list<int>::node_capacity << endl;
+
+    // 1. splice, as in container_demo: move {3, 4, 5} to the front
+    unrolled_list<int> lst;
+    for (int i = 1; i <= 5; ++i) {
+        lst.push_back(i);
+    }
+    auto first = lst.begin();
+    ++first;
+    ++first;
+    lst.splice(lst.begin(), lst, first, lst.end());
+    cout << "After splice: ";
+    for (int n : lst) cout << n << " ";
+    cout << "\n";
+
+    // 2. insert_after / erase through stable handles (forward_list pattern)
+    auto h3 = lst.begin().get_handle();
+    auto h0 = lst.insert_after(h3, 0);
+    lst.insert_before(h0, -1);
+    lst.erase(h3);
+    cout << "After insert_after/erase: ";
+    for (int n : lst) cout << n << " ";
+    cout << "(handle still reads " << lst[h0] << ")\n";
+
+    // 3. Lists sharing a pool can splice whole node ranges between each other
+    auto pool = make_shared<unrolled_list<int>::pool_type>();
+    unrolled_list<int> bids(pool), asks(pool);
+    vector<unrolled_list<int>::handle> orders;
+    for (int i = 0; i < 100; ++i) {
+        orders.push_back(bids.push_back(i));
+    }
+    for (size_t i = 0; i < orders.size(); i += 3) {
+        bids.erase(orders[i]);  // Cancel every third order
+    }
+    cout << "Bids: " << bids.size() << " in " << bids.node_count() << " nodes";
+    bids.compact();
+    cout << ", after compact(): " << bids.node_count() << " nodes" << endl;
+    asks.splice(asks.end(), bids);
+    cout << "Moved to asks: " << asks.size() << ", bids left: " << bids.size()
+         << ", order #1 = " << asks[orders[1]] << endl;
+
+    // 4. Traversal benchmark after middle insert/erase churn
+    const int count = 1000000;
+    const int churn = 200000;
+    mt19937 rng(42);
+    uniform_int_distribution<int> pick(0, count - 1);
+
+    list<int> std_list;
+    vector<list<int>::iterator> list_its;
+    unrolled_list<int> unrolled;
+    vector<unrolled_list<int>::handle> handles;
+    for (int i = 0; i < count; ++i) {
+        list_its.push_back(std_list.insert(std_list.end(), i));
+        handles.push_back(unrolled.push_back(i));
+    }
+    for (int i = 0; i < churn; ++i) {
+        int k = pick(rng);
+        int r = pick(rng);
+        if (k == r) continue;
+        std_list.erase(list_its[k]);
+        list_its[k] = std_list.insert(next(list_its[r]), i);
+        unrolled.erase(handles[k]);
+        handles[k] = unrolled.insert_after(handles[r], i);
+    }
+    vector<int> contiguous(std_list.begin(), std_list.end());
+
+    long long sum = 0;
+    cout << "\nTraversal of " << count << " ints after " << churn << " middle edits:" << endl;
+    cout << "  std::list:               " << time_traversal(std_list, sum) << " us" << endl;
+    cout << "  unrolled_list:           " << time_traversal(unrolled, sum) << " us ("
+         << unrolled.node_count() << " nodes)" << endl;
+    unrolled.compact();
+    cout << "  unrolled_list (compact): " << time_traversal(unrolled, sum) << " us ("
+         << unrolled.node_count() << " nodes)" << endl;
+    cout << "  std::vector:             " << time_traversal(contiguous, sum) << " us" << endl;
+    if (sum == 0) cout << "(checksum " << sum << ")\n";  // Keep the loops observable
+
+    cout << "unrolled_list demo completed.\n";
+}
+
 // Function declarations for C compatibility
 
 #ifdef __cplusplus
@@ -577,6 +788,8 @@ void run_algorithm_demo() { algorithm_demo(); }
 void run_container_demo() { container_demo(); }
 void run_smart_pointer_demo() { smart_pointer_demo(); }
 void run_container_utils_demo() { container_utils_demo(); }
+void run_mmap_vector_demo() { mmap_vector_demo(); }
+void run_unrolled_list_demo() { unrolled_list_demo(); }
 #ifdef __cplusplus
 }
 #endif
@@ -14,6 +14,8 @@ void run_algorithm_demo();
 void run_container_demo();     // Additional container types
 void run_smart_pointer_demo(); // Smart pointers and memory management
 void run_container_utils_demo(); // Queue, Deque, Stack, and algorithms
+void run_mmap_vector_demo();   // mremap-grown vector vs std::vector benchmark
+void run_unrolled_list_demo(); // Pool-backed unrolled list vs std::list traversal
 
 #ifdef __cplusplus
 }
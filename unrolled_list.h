@@ -0,0 +1,506 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Node pool shared by unrolled_list instances.
+//
+// - Nodes are 64-byte aligned and handed out from blocks of block_nodes,
+//   so neighbouring nodes of a freshly built list sit next to each other.
+// - The default NodeBytes = 128 is two cache lines: the links, owner id, count
+//   and one handle per slot take 24 bytes plus 4 per element, so a single line
+//   would hold only 5 ints, while two hold 13 and are fetched as a pair by the
+//   adjacent-line prefetcher. Pass NodeBytes = 64 for single-line nodes.
+// - The handle table lives here too: a handle names one element for its whole
+//   lifetime, even when inserts, splices or compact() move it to another node.
+//   Handles carry a generation that erase bumps, so a stale handle is rejected
+//   even after its table slot has been reused (until 2^32 reuses of one slot).
+// - Lists that share a pool can splice node ranges between each other.
+template <typename T, std::size_t NodeBytes = 128>
+class unrolled_pool {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "unrolled_list shifts elements with memmove");
+
+public:
+    using handle = std::uint64_t;        // Generation in the high 32 bits, table index in the low 32
+    using handle_index = std::uint32_t;  // What nodes store per slot
+    using list_id = std::uint32_t;
+    static constexpr handle npos = static_cast<handle>(-1);
+
+    // Elements per node: whatever fits next to the links, count and handle slots
+    static constexpr std::size_t node_header = 2 * sizeof(void*) + sizeof(list_id) + sizeof(std::uint32_t);
+    static constexpr std::size_t node_capacity =
+        NodeBytes > node_header + sizeof(handle_index) + sizeof(T)
+            ? (NodeBytes - node_header) / (sizeof(handle_index) + sizeof(T))
+            : 1;
+    static constexpr std::size_t block_nodes = 64;
+
+    struct alignas(64) node {
+        node* prev;
+        node* next;
+        list_id owner;  // Id of the list the node is linked into, for handle checks
+        std::uint32_t count;
+        handle_index handles[node_capacity];
+        alignas(T) unsigned char storage[node_capacity * sizeof(T)];
+
+        T* items() { return reinterpret_cast<T*>(storage); }
+    };
+
+    struct location {
+        node* where;
+        std::uint32_t slot;
+        std::uint32_t generation;
+    };
+
+    static handle_index index_of(handle h) { return static_cast<handle_index>(h); }
+
+    unrolled_pool() = default;
+    unrolled_pool(const unrolled_pool&) = delete;
+    unrolled_pool& operator=(const unrolled_pool&) = delete;
+
+    node* allocate_node(list_id owner) {
+        if (!free_nodes_) add_block();
+        node* n = free_nodes_;
+        free_nodes_ = n->next;
+        return reset(n, owner);
+    }
+
+    // Hands out n nodes in ascending address order, topping the free list up
+    // with fresh blocks first, so a list rebuilt from them walks memory forward.
+    // The remaining free nodes are relinked in address order as well.
+    std::vector<node*> allocate_ordered(std::size_t n, list_id owner) {
+        std::size_t free_count = 0;
+        for (node* p = free_nodes_; p; p = p->next) ++free_count;
+        while (free_count < n) {
+            add_block();
+            free_count += block_nodes;
+        }
+
+        std::vector<node*> sorted;
+        sorted.reserve(free_count);
+        for (node* p = free_nodes_; p; p = p->next) sorted.push_back(p);
+        std::sort(sorted.begin(), sorted.end(), std::less<node*>());
+
+        free_nodes_ = nullptr;
+        for (std::size_t i = sorted.size(); i-- > n;) {
+            sorted[i]->next = free_nodes_;
+            free_nodes_ = sorted[i];
+        }
+        sorted.resize(n);
+        for (node* p : sorted) reset(p, owner);
+        return sorted;
+    }
+
+    void free_node(node* n) {
+        n->next = free_nodes_;
+        free_nodes_ = n;
+    }
+
+    handle allocate_handle(node* where, std::uint32_t slot) {
+        handle_index i;
+        if (!free_handles_.empty()) {
+            i = free_handles_.back();
+            free_handles_.pop_back();
+        } else {
+            i = static_cast<handle_index>(handles_.size());
+            handles_.push_back({nullptr, 0, 0});
+        }
+        handles_[i].where = where;
+        handles_[i].slot = slot;
+        return handle_of(i);
+    }
+
+    void free_handle(handle_index i) {
+        handles_[i].where = nullptr;
+        ++handles_[i].generation;  // Outstanding copies of the handle stop validating
+        free_handles_.push_back(i);
+    }
+
+    handle handle_of(handle_index i) const {
+        return static_cast<handle>(handles_[i].generation) << 32 | i;
+    }
+
+    location& locate(handle h) { return handles_[index_of(h)]; }
+    const location& locate(handle h) const { return handles_[index_of(h)]; }
+    location& entry(handle_index i) { return handles_[i]; }
+
+    bool valid(handle h) const {
+        handle_index i = index_of(h);
+        return i < handles_.size() && handles_[i].where &&
+               handles_[i].generation == static_cast<std::uint32_t>(h >> 32);
+    }
+
+    // Lists keep their id across moves, so moving a list never touches its nodes
+    list_id issue_list_id() { return ++next_list_id_; }
+
+    std::size_t allocated_nodes() const { return blocks_.size() * block_nodes; }
+
+private:
+    void add_block() {
+        blocks_.emplace_back(new node[block_nodes]);
+        node* block = blocks_.back().get();
+        for (std::size_t i = block_nodes; i-- > 0;) {
+            block[i].next = free_nodes_;
+            free_nodes_ = &block[i];
+        }
+    }
+
+    static node* reset(node* n, list_id owner) {
+        n->prev = n->next = nullptr;
+        n->owner = owner;
+        n->count = 0;
+        return n;
+    }
+
+    std::vector<std::unique_ptr<node[]>> blocks_;
+    node* free_nodes_ = nullptr;
+    std::vector<location> handles_;
+    std::vector<handle_index> free_handles_;
+    list_id next_list_id_ = 0;
+};
+
+// Unrolled doubly-linked list: each pool node holds up to node_capacity
+// elements, so traversal walks mostly-contiguous memory instead of one heap
+// node per element.
+//
+// - Inserts return a stable handle; insert_before/insert_after/erase take one,
+//   covering the std::list / forward_list::insert_after middle-edit pattern.
+// - splice() relinks whole nodes; only the two range ends and the insert
+//   position may be split. Within one list the cost does not grow with the
+//   range length; across lists it walks the moved nodes once to update size().
+// - compact() rebuilds the list into full, address-ordered nodes, undoing both
+//   the partial fill and the scattering that erases and splits leave behind.
+template <typename T, std::size_t NodeBytes = 128>
+class unrolled_list {
+public:
+    using pool_type = unrolled_pool<T, NodeBytes>;
+    using handle = typename pool_type::handle;
+    using value_type = T;
+    using size_type = std::size_t;
+    static constexpr handle npos = pool_type::npos;
+    static constexpr std::size_t node_capacity = pool_type::node_capacity;
+
+private:
+    using node = typename pool_type::node;
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        iterator(pool_type* pool, node* n, std::uint32_t slot) : pool_(pool), node_(n), slot_(slot) {}
+
+        reference operator*() const { return node_->items()[slot_]; }
+        pointer operator->() const { return &node_->items()[slot_]; }
+        handle get_handle() const { return pool_->handle_of(node_->handles[slot_]); }
+
+        iterator& operator++() {
+            if (++slot_ == node_->count) {
+                node_ = node_->next;
+                slot_ = 0;
+            }
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const iterator& o) const { return node_ == o.node_ && slot_ == o.slot_; }
+        bool operator!=(const iterator& o) const { return !(*this == o); }
+
+    private:
+        pool_type* pool_ = nullptr;
+        node* node_ = nullptr;
+        std::uint32_t slot_ = 0;
+    };
+
+    unrolled_list() : unrolled_list(std::make_shared<pool_type>()) {}
+    explicit unrolled_list(std::shared_ptr<pool_type> pool)
+        : pool_(std::move(pool)), id_(pool_->issue_list_id()) {}
+
+    unrolled_list(const unrolled_list&) = delete;
+    unrolled_list& operator=(const unrolled_list&) = delete;
+
+    // O(1): the nodes keep their owner id, and other gets a fresh one
+    unrolled_list(unrolled_list&& other) noexcept
+        : pool_(other.pool_),
+          id_(std::exchange(other.id_, other.pool_->issue_list_id())),
+          head_(std::exchange(other.head_, nullptr)),
+          tail_(std::exchange(other.tail_, nullptr)),
+          size_(std::exchange(other.size_, 0)) {}
+
+    unrolled_list& operator=(unrolled_list&& other) noexcept {
+        unrolled_list tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    ~unrolled_list() { clear(); }
+
+    const std::shared_ptr<pool_type>& pool() const { return pool_; }
+
+    // Element access
+    T& operator[](handle h) {
+        auto& loc = pool_->locate(h);
+        return loc.where->items()[loc.slot];
+    }
+    T& at(handle h) {
+        if (!owns(h)) throw std::out_of_range("unrolled_list::at");
+        return (*this)[h];
+    }
+    T& front() { return head_->items()[0]; }
+    T& back() { return tail_->items()[tail_->count - 1]; }
+
+    // Iterators
+    iterator begin() { return head_ ? iterator(pool_.get(), head_, 0) : end(); }
+    iterator end() { return iterator(); }
+    iterator find(handle h) {
+        auto& loc = pool_->locate(h);
+        return iterator(pool_.get(), loc.where, loc.slot);
+    }
+
+    // Capacity
+    bool empty() const { return size_ == 0; }
+    size_type size() const { return size_; }
+    size_type node_count() const {
+        size_type n = 0;
+        for (node* p = head_; p; p = p->next) ++n;
+        return n;
+    }
+
+    // Modifiers
+    handle push_back(const T& value) {
+        return tail_ ? insert_at(tail_, tail_->count, value) : insert_into_empty(value);
+    }
+
+    handle push_front(const T& value) {
+        return head_ ? insert_at(head_, 0, value) : insert_into_empty(value);
+    }
+
+    handle insert_before(handle pos, const T& value) {
+        assert(owns(pos));
+        auto& loc = pool_->locate(pos);
+        return insert_at(loc.where, loc.slot, value);
+    }
+
+    handle insert_after(handle pos, const T& value) {
+        assert(owns(pos));
+        auto& loc = pool_->locate(pos);
+        return insert_at(loc.where, loc.slot + 1, value);
+    }
+
+    void erase(handle h) {
+        assert(owns(h));
+        auto loc = pool_->locate(h);
+        node* n = loc.where;
+        move_items(n, loc.slot + 1, n, loc.slot, n->count - loc.slot - 1);
+        --n->count;
+        --size_;
+        pool_->free_handle(pool_type::index_of(h));
+        if (n->count == 0) {
+            unlink(n, n);
+            pool_->free_node(n);
+        }
+    }
+
+    void pop_front() { erase(pool_->handle_of(head_->handles[0])); }
+    void pop_back() { erase(pool_->handle_of(tail_->handles[tail_->count - 1])); }
+
+    void clear() {
+        for (node* n = head_; n;) {
+            node* next = n->next;
+            for (std::uint32_t i = 0; i < n->count; ++i) pool_->free_handle(n->handles[i]);
+            pool_->free_node(n);
+            n = next;
+        }
+        head_ = tail_ = nullptr;
+        size_ = 0;
+    }
+
+    // Moves [first, last) of other in front of pos. other may be *this (pos
+    // must then lie outside the range); otherwise both lists must share a pool.
+    void splice(iterator pos, unrolled_list& other, iterator first, iterator last) {
+        if (first == last || (&other == this && pos == first)) return;
+        if (pool_ != other.pool_) throw std::invalid_argument("unrolled_list::splice: different pools");
+
+        // Capture handles first: splitting nodes invalidates iterators
+        handle hp = pos == end() ? npos : pos.get_handle();
+        handle hf = first.get_handle();
+        handle hl = last == other.end() ? npos : last.get_handle();
+
+        node* chain_head = other.split_before(hf);
+        node* stop = hl == npos ? nullptr : other.split_before(hl);
+        node* chain_tail = stop ? stop->prev : other.tail_;
+
+        size_type moved = 0;
+        if (&other != this) {
+            for (node* n = chain_head; n != stop; n = n->next) {
+                moved += n->count;
+                n->owner = id_;
+            }
+        }
+        other.unlink(chain_head, chain_tail);
+        other.size_ -= moved;
+
+        node* before = hp == npos ? nullptr : split_before(hp);
+        link_before(before, chain_head, chain_tail);
+        size_ += moved;
+    }
+
+    void splice(iterator pos, unrolled_list& other) {
+        splice(pos, other, other.begin(), other.end());
+    }
+
+    void swap(unrolled_list& other) noexcept {
+        std::swap(pool_, other.pool_);
+        std::swap(id_, other.id_);
+        std::swap(head_, other.head_);
+        std::swap(tail_, other.tail_);
+        std::swap(size_, other.size_);
+    }
+
+    // Copies the elements in list order into as few nodes as possible, taken
+    // from the pool in address order, then frees the old chain. Handles stay
+    // valid; iterators do not.
+    void compact() {
+        if (!head_) return;
+        std::vector<node*> fresh =
+            pool_->allocate_ordered((size_ + node_capacity - 1) / node_capacity, id_);
+
+        node* src = head_;
+        head_ = tail_ = nullptr;
+        node* dst = nullptr;
+        std::size_t used = 0;
+        while (src) {
+            for (std::uint32_t taken = 0; taken < src->count;) {
+                if (!dst || dst->count == node_capacity) {
+                    dst = fresh[used++];
+                    link_before(nullptr, dst, dst);
+                }
+                std::uint32_t n = std::min<std::uint32_t>(src->count - taken,
+                                                          node_capacity - dst->count);
+                move_items(src, taken, dst, dst->count, n);
+                dst->count += n;
+                taken += n;
+            }
+            node* next = src->next;
+            pool_->free_node(src);
+            src = next;
+        }
+    }
+
+    // True when h has not been erased and names an element of this list, not
+    // just of the pool
+    bool owns(handle h) const {
+        return pool_->valid(h) && pool_->locate(h).where->owner == id_;
+    }
+
+private:
+    handle insert_into_empty(const T& value) {
+        node* n = pool_->allocate_node(id_);
+        head_ = tail_ = n;
+        return insert_at(n, 0, value);
+    }
+
+    handle insert_at(node* n, std::uint32_t slot, const T& value) {
+        const T copy = value;  // value may live in a slot that is about to move
+        if (n->count == node_capacity) {
+            if (slot == node_capacity || slot == 0) {
+                // Appending at either edge: start a fresh node so sequential
+                // push_back/push_front keep nodes full
+                node* m = pool_->allocate_node(id_);
+                if (slot == 0) {
+                    link_before(n, m, m);
+                } else {
+                    link_before(n->next, m, m);
+                }
+                n = m;
+                slot = 0;
+            } else {
+                std::uint32_t half = node_capacity / 2;
+                node* m = split_at(n, half);
+                if (slot > half) {
+                    n = m;
+                    slot -= half;
+                }
+            }
+        }
+        move_items(n, slot, n, slot + 1, n->count - slot);
+        new (&n->items()[slot]) T(copy);
+        handle h = pool_->allocate_handle(n, slot);
+        n->handles[slot] = pool_type::index_of(h);
+        ++n->count;
+        ++size_;
+        return h;
+    }
+
+    // Returns the node that starts with h, splitting h's node if needed
+    node* split_before(handle h) {
+        auto loc = pool_->locate(h);
+        return loc.slot == 0 ? loc.where : split_at(loc.where, loc.slot);
+    }
+
+    // Moves slots [slot, count) of n into a new node linked right after n
+    node* split_at(node* n, std::uint32_t slot) {
+        node* m = pool_->allocate_node(id_);
+        move_items(n, slot, m, 0, n->count - slot);
+        m->count = n->count - slot;
+        n->count = slot;
+        link_before(n->next, m, m);
+        return m;
+    }
+
+    // Moves n elements and their handles, repointing the handle table at the new slots
+    void move_items(node* src, std::uint32_t from, node* dst, std::uint32_t to, std::uint32_t n) {
+        if (n == 0) return;
+        std::memmove(&dst->items()[to], &src->items()[from], n * sizeof(T));
+        std::memmove(&dst->handles[to], &src->handles[from], n * sizeof(dst->handles[0]));
+        for (std::uint32_t i = to; i < to + n; ++i) {
+            auto& loc = pool_->entry(dst->handles[i]);
+            loc.where = dst;
+            loc.slot = i;
+        }
+    }
+
+    // Links the chain [first, last] in front of before (nullptr appends)
+    void link_before(node* before, node* first, node* last) {
+        node* prev = before ? before->prev : tail_;
+        first->prev = prev;
+        last->next = before;
+        if (prev) prev->next = first; else head_ = first;
+        if (before) before->prev = last; else tail_ = last;
+    }
+
+    void unlink(node* first, node* last) {
+        if (first->prev) first->prev->next = last->next; else head_ = last->next;
+        if (last->next) last->next->prev = first->prev; else tail_ = first->prev;
+        first->prev = last->next = nullptr;
+    }
+
+    std::shared_ptr<pool_type> pool_;
+    typename pool_type::list_id id_;
+    node* head_ = nullptr;
+    node* tail_ = nullptr;
+    size_type size_ = 0;
+};
+
+#endif // UNROLLED_LIST_H